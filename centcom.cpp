@@ -1,4 +1,5 @@
 #include "centcom.h" 
+#include <climits>
 
 // CentCom constructor: Initializes central control for building elevators
 CentCom::CentCom(int numElevators, int buildingID) {
@@ -40,6 +41,8 @@ bool CentCom::addElevator(int ID, int bottomFloor, int topFloor) {
         return false;
     if (bottomFloor > topFloor)
         return false;
+    if ((long long)topFloor - bottomFloor + 1 > MAXFLOORS)
+        return false;
 
     // Delete existing elevator if ID is reused
     if (m_elevatorsList[ID] != nullptr) {
@@ -100,6 +103,60 @@ bool CentCom::clearEmergency(int ID) {
     return true;
 }
 
+// Applies a batch of events in order, returns how many were accepted
+int CentCom::processBatch(const Event events[], int count) {
+    if (events == nullptr || count <= 0)
+        return 0;
+
+    int accepted = 0;
+    for (int i = 0; i < count; i++) {
+        if (processEvent(events[i]))
+            accepted++;
+    }
+    return accepted;
+}
+
+// Applies a single event, returns false if it was rejected
+bool CentCom::processEvent(const Event &event) {
+    switch (event.m_command) {
+        case ADD:
+            return addElevator(event.m_id, event.m_arg1, event.m_arg2);
+        case SECURE:
+            return setSecure(event.m_id, event.m_arg1, event.m_arg2 != 0);
+        case CLEAR:
+            return clearEmergency(event.m_id);
+        default:
+            break;
+    }
+
+    // The remaining commands go to an elevator that has to exist already
+    Elevator *elevator = getElevator(event.m_id);
+    if (elevator == nullptr)
+        return false;
+    switch (event.m_command) {
+        case BUTTON:
+            return elevator->pushButton(event.m_arg1);
+        case PROCESS:
+            return elevator->processNextRequest();
+        case EMERGENCY:
+            elevator->pushEmergency(true);
+            return true;
+        case ENTER:
+            // A negative load or one that would overflow the total is rejected
+            if (event.m_arg1 < 0 || event.m_arg1 > INT_MAX - elevator->m_load)
+                return false;
+            elevator->enter(event.m_arg1);
+            return true;
+        case EXIT:
+            if (event.m_arg1 < 0)
+                return false;
+            elevator->exit(event.m_arg1);
+            return true;
+        default:
+            return false;
+    }
+}
+
 // Elevator constructor: Initializes an Elevator object
 Elevator::Elevator(int ID) {
     m_id = ID;
@@ -195,14 +252,18 @@ void Elevator::setUp(int firstFloor, int lastFloor) {
         cout << "First floor number is greater than last floor number." << endl;
         return;
     }
+    if ((long long)lastFloor - firstFloor + 1 > MAXFLOORS) {
+        cout << "Elevator cannot serve more than " << MAXFLOORS << " floors." << endl;
+        return;
+    }
 
     m_bottom = new Floor(firstFloor); // Create first floor
     m_top = m_bottom;
     Floor *current = m_bottom;
 
     // Create remaining floors and link them
-    for (int i = firstFloor + 1; i <= lastFloor; i++) {
-        Floor *newFloor = new Floor(i);
+    for (int i = firstFloor; i < lastFloor; i++) {
+        Floor *newFloor = new Floor(i + 1); // i + 1 never passes lastFloor, so no overflow
         current->m_next = newFloor;
         newFloor->m_previous = current;
         current = newFloor;
@@ -276,6 +337,14 @@ bool Elevator::pushButton(int floor) {
         return false;
     }
 
+    // Ignore a floor that is already waiting, each queue holds a floor at most once
+    Floor *pending = (floor < m_currentFloor->m_floorNum) ? m_downRequests : m_upRequests;
+    while (pending != nullptr) {
+        if (pending->m_floorNum == floor)
+            return false;
+        pending = pending->m_next;
+    }
+
     // Add request to appropriate queue (down or up)
     if (floor < m_currentFloor->m_floorNum) {
         Floor *newRequest = new Floor(floor);
@@ -331,7 +400,12 @@ bool Elevator::processNextRequest() {
     if (nextRequest == nullptr)
         return false; // No pending requests
 
-    m_currentFloor = nextRequest; // Move elevator to requested floor
+    // Move elevator to the building floor matching the request
+    Floor *target = m_bottom;
+    while (target != nullptr && target->m_floorNum != nextRequest->m_floorNum)
+        target = target->m_next;
+    if (target != nullptr)
+        m_currentFloor = target;
 
     // Remove the processed request from its list
     if (m_moveState == UP) {
@@ -349,6 +423,7 @@ bool Elevator::processNextRequest() {
         if (nextRequest->m_next != nullptr)
             nextRequest->m_next->m_previous = nextRequest->m_previous;
     }
+    delete nextRequest; // The request node is no longer referenced
 
     m_doorState = OPEN; // Open door at destination
     return true;
@@ -356,11 +431,18 @@ bool Elevator::processNextRequest() {
 
 // Increases the current load of the elevator
 void Elevator::enter(int load) {
-    m_load += load;
+    if (load < 0)
+        return; // A load cannot be negative
+    if (load > INT_MAX - m_load)
+        m_load = INT_MAX; // Saturate instead of overflowing
+    else
+        m_load += load;
 }
 
 // Decreases the current load of the elevator
 int Elevator::exit(int load) {
+    if (load < 0)
+        return m_load; // A load cannot be negative
     m_load -= load;
     if (m_load < 0)
         m_load = 0; // Prevent negative load
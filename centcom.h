@@ -9,8 +9,18 @@ enum DIRECTION {IDLE,UP,DOWN};  // possible states
 enum DOOR {OPEN,CLOSED};        // possible states
 const int LOADLIMIT = 2000;     // lbs, max load that an elevator can lift
 const int INVALIDID = -1;       // Elevator ID is positive and starts at zero
+const int MAXFLOORS = 1000;     // most floors a single elevator can serve
+enum COMMAND {ADD,SECURE,BUTTON,PROCESS,EMERGENCY,CLEAR,ENTER,EXIT}; // commands in a batch
 class Tester;
 
+struct Event{
+    long long m_time;   // timestamp as recorded in the log, not used by CentCom
+    COMMAND m_command;
+    int m_id;           // elevator ID
+    int m_arg1;         // floor, bottom floor or load depending on the command
+    int m_arg2;         // top floor for ADD, secured flag for SECURE
+};
+
 class Floor{
     friend class Tester;
     friend class Elevator;
@@ -69,7 +79,9 @@ class CentCom{
     bool setSecure(int ID, int floorNum, bool yes_no);
     Elevator* getElevator(int ID);
     bool clearEmergency(int ID);
+    int processBatch(const Event events[], int count); // applies events in order, returns number accepted
     private:
+    bool processEvent(const Event &event);
     int m_id;           // the building ID (unique), it is positive and starts at zero
     int m_numElevators; // number of elevators (array size, not number of created elevators)
     Elevator ** m_elevatorsList; // this is an array holding elevator pointers.
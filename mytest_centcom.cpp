@@ -1,5 +1,10 @@
 #include "centcom.h"
+#include "trace.h"
 #include<iostream>
+#include<string>
+#include<cstring>
+#include<climits>
+#include<type_traits>
 using namespace std;
 
 
@@ -10,14 +15,33 @@ public:
     bool testCentComConstructorErrorCase();
     bool testCentComAddElevatorNormalCase();
     bool testCentComAddElevatorErrorCase();
+    bool testCentComAddElevatorFloorLimitCase();
+    bool testCentComProcessBatchNormalCase();
+    bool testCentComProcessBatchErrorCase();
+    bool testCentComProcessBatchLoadCase();
 
     //Elevator Tests
     bool testElevatorSetUpErrorCase();
+    bool testElevatorSetUpTopFloorCase();
     bool testElevatorInsertFloorErrorCase();
     bool testElevatorPushButtonNormalCase();
     bool testElevatorPushButtonErrorCase();
+    bool testElevatorPushButtonDuplicateCase();
     bool testElevatorProcessNextRequestNormalCase();
     bool testElevatorProcessNextRequestErrorCase();
+    bool testElevatorProcessNextRequestFloorCase();
+    bool testElevatorEnterErrorCase();
+
+    //TraceReplay Tests
+    bool testTraceConstructorErrorCase();
+    bool testTraceParseLineNormalCase();
+    bool testTraceParseLineErrorCase();
+    bool testTraceIngestChunkSplitCase();
+    bool testTraceIngestNoTrailingNewlineCase();
+    bool testTraceIngestLongLineCase();
+
+private:
+    bool parseTraceLine(const char* line, Event& event);
 
 };
 
@@ -63,6 +87,65 @@ bool Tester::testCentComAddElevatorErrorCase(){
     return (!result); // Expect addElevator to return false for an invalid ID
 }
 
+bool Tester::testCentComAddElevatorFloorLimitCase(){
+    CentCom centcom(5,1); // Create a CentCom object
+    if (!centcom.addElevator(1,0,MAXFLOORS-1))
+    {
+        return false; // Exactly MAXFLOORS floors is allowed
+    }
+    Event events[] = {
+        {0, ADD, 2, INT_MIN, INT_MAX-1},    // about 4 billion floors
+        {1, ADD, 3, 0, MAXFLOORS}           // one floor too many
+    };
+    return (!centcom.addElevator(2,-5,MAXFLOORS) && centcom.processBatch(events, 2) == 0 &&
+            centcom.getElevator(2) == nullptr && centcom.getElevator(3) == nullptr); // Oversized buildings are rejected
+}
+
+bool Tester::testCentComProcessBatchNormalCase(){
+    CentCom centcom(5,1); // Create a CentCom object
+    Event events[] = {
+        {0, ADD, 2, 0, 10},     // set up elevator 2 with floors 0 to 10
+        {1, SECURE, 2, 4, 1},   // secure floor 4
+        {2, BUTTON, 2, 6, 0},   // request floor 6
+        {3, PROCESS, 2, 0, 0},  // move to floor 6
+        {4, ENTER, 2, 300, 0}   // 300 lbs enter
+    };
+    int accepted = centcom.processBatch(events, 5); // Apply the whole batch
+    if (accepted != 5)
+    {
+        return false; // Every event in the batch is valid
+    }
+
+    Elevator* elevator = centcom.getElevator(2);
+    return (elevator != nullptr && elevator->m_currentFloor->m_floorNum == 6 &&
+            elevator->checkSecure(4) && elevator->m_load == 300); // Check the batch was applied in order
+}
+
+bool Tester::testCentComProcessBatchErrorCase(){
+    CentCom centcom(5,1); // Create a CentCom object
+    Event events[] = {
+        {0, BUTTON, 3, 6, 0},   // elevator 3 does not exist yet
+        {1, ADD, 7, 0, 10},     // ID out of range
+        {2, ADD, 3, 0, 10},     // valid
+        {3, BUTTON, 3, 20, 0}   // floor out of range
+    };
+    int accepted = centcom.processBatch(events, 4); // Apply the batch
+    return (accepted == 1 && centcom.processBatch(nullptr, 3) == 0); // Only the valid ADD is accepted
+}
+
+bool Tester::testCentComProcessBatchLoadCase(){
+    CentCom centcom(5,1); // Create a CentCom object
+    Event events[] = {
+        {0, ADD, 1, 0, 10},                 // set up elevator 1
+        {1, ENTER, 1, 2000000000, 0},       // valid
+        {2, ENTER, 1, 2000000000, 0},       // would overflow the total load
+        {3, ENTER, 1, -5000, 0},            // negative load
+        {4, EXIT, 1, -5000, 0}              // negative load
+    };
+    int accepted = centcom.processBatch(events, 5); // Apply the batch
+    return (accepted == 2 && centcom.getElevator(1)->m_load == 2000000000); // Only the first load is applied
+}
+
 //Elevator Test Implementations
 bool Tester::testElevatorSetUpErrorCase(){
     Elevator elevator(1); // Create an Elevator object
@@ -70,6 +153,16 @@ bool Tester::testElevatorSetUpErrorCase(){
     return (elevator.m_bottom == nullptr && elevator.m_top == nullptr); // Expect m_bottom and m_top to remain nullptr
 }
 
+bool Tester::testElevatorSetUpTopFloorCase(){
+    Elevator elevator(1); // Create an Elevator object
+    elevator.setUp(INT_MAX-7,INT_MAX); // Eight floors ending at the largest int
+
+    int count = 0;
+    for (Floor* temp = elevator.m_bottom; temp != nullptr; temp = temp->m_next)
+        count++;
+    return (count == 8 && elevator.m_top->m_floorNum == INT_MAX); // The loop must stop at the top floor
+}
+
 bool Tester::testElevatorInsertFloorErrorCase(){
     Elevator elevator(1); // Create an Elevator object
     elevator.setUp(1,10); // Set up a valid floor range
@@ -121,6 +214,185 @@ bool Tester::testElevatorProcessNextRequestErrorCase(){
     return (!result); // Expect processNextRequest to return false during an emergency
 }
 
+bool Tester::testElevatorPushButtonDuplicateCase(){
+    Elevator elevator(1); // Create an Elevator object
+    elevator.setUp(1,10); // Set up a valid floor range
+    elevator.pushButton(5); // First request for floor 5
+    bool result = elevator.pushButton(5); // Push the same button again
+    if (result)
+    {
+        return false; // A floor that is already waiting must not be queued twice
+    }
+
+    return (elevator.m_upRequests != nullptr && elevator.m_upRequests->m_next == nullptr); // Only one request should be queued
+}
+
+bool Tester::testElevatorProcessNextRequestFloorCase(){
+    Elevator elevator(1); // Create an Elevator object
+    elevator.setUp(1,10); // Set up a valid floor range
+    elevator.pushButton(5); // Add a request to go to floor 5
+    elevator.pushButton(7); // Add a request to go to floor 7
+    elevator.processNextRequest(); // Move to floor 5
+
+    // The current floor must be the building floor node, linked to its neighbours
+    return (elevator.m_currentFloor->m_floorNum == 5 &&
+            elevator.m_currentFloor->m_previous != nullptr && elevator.m_currentFloor->m_previous->m_floorNum == 4 &&
+            elevator.m_upRequests != nullptr && elevator.m_upRequests->m_floorNum == 7 && elevator.m_upRequests->m_next == nullptr);
+}
+bool Tester::testElevatorEnterErrorCase(){
+    Elevator elevator(1); // Create an Elevator object
+    elevator.setUp(1,10); // Set up a valid floor range
+    elevator.enter(-3000); // A negative load must not lower the total
+    elevator.exit(-3000); // Nor raise it through exit
+    if (elevator.m_load != 0)
+    {
+        return false;
+    }
+    elevator.enter(INT_MAX);
+    elevator.enter(INT_MAX); // Would overflow
+    return (elevator.m_load == INT_MAX && !elevator.processNextRequest()); // Saturated load stays above LOADLIMIT
+}
+
+//TraceReplay Test Implementations
+
+// Writes text to a temporary file and rewinds it so it can be replayed
+FILE* makeTrace(const string& text){
+    FILE* trace = tmpfile();
+    if (trace != nullptr)
+    {
+        fwrite(text.c_str(), 1, text.size(), trace);
+        rewind(trace);
+    }
+    return trace;
+}
+
+// Parses a null terminated line through TraceReplay::parseLine
+bool Tester::parseTraceLine(const char* line, Event& event){
+    return TraceReplay::parseLine(line, line + strlen(line), event);
+}
+
+bool Tester::testTraceConstructorErrorCase(){
+    // TraceReplay owns raw buffers, copying it would free them twice
+    if (is_copy_constructible<TraceReplay>::value || is_copy_assignable<TraceReplay>::value)
+        return false;
+
+    CentCom centcom(3,1);
+    int failures = 0;
+    try{
+        TraceReplay replay(nullptr); // No controller
+    }
+    catch(const invalid_argument& e){
+        failures++;
+    }
+    try{
+        TraceReplay replay(&centcom, 0); // Empty chunk
+    }
+    catch(const invalid_argument& e){
+        failures++;
+    }
+    try{
+        TraceReplay replay(&centcom, INT_MAX); // Chunk plus carry would overflow
+    }
+    catch(const invalid_argument& e){
+        failures++;
+    }
+    return (failures == 3); // Every invalid construction throws
+}
+
+bool Tester::testTraceParseLineNormalCase(){
+    Event event;
+    // Every command with its expected argument count
+    if (!parseTraceLine("0,add,1,-2,20", event) || event.m_command != ADD || event.m_id != 1 || event.m_arg1 != -2 || event.m_arg2 != 20)
+        return false;
+    if (!parseTraceLine("1,secure,1,5,1", event) || event.m_command != SECURE || event.m_arg1 != 5 || event.m_arg2 != 1)
+        return false;
+    if (!parseTraceLine("2,button,1,8", event) || event.m_command != BUTTON || event.m_arg1 != 8)
+        return false;
+    if (!parseTraceLine("3,process,1", event) || event.m_command != PROCESS || event.m_id != 1)
+        return false;
+    if (!parseTraceLine("4,emergency,1", event) || event.m_command != EMERGENCY)
+        return false;
+    if (!parseTraceLine("5,clear,1", event) || event.m_command != CLEAR)
+        return false;
+    if (!parseTraceLine("6,enter,1,300", event) || event.m_command != ENTER || event.m_arg1 != 300)
+        return false;
+    if (!parseTraceLine("7,exit,1,100", event) || event.m_command != EXIT || event.m_arg1 != 100)
+        return false;
+
+    // CRLF line ending and a timestamp beyond the int range
+    if (!parseTraceLine("8,button,2,7\r", event) || event.m_arg1 != 7)
+        return false;
+    return (parseTraceLine("1700000000000,process,2", event) && event.m_time == 1700000000000LL);
+}
+
+bool Tester::testTraceParseLineErrorCase(){
+    Event event;
+    return (!parseTraceLine("1,button,2,3,4", event) &&        // trailing field
+            !parseTraceLine("1,process,2x", event) &&          // trailing text
+            !parseTraceLine("1,add,2,0", event) &&             // missing field
+            !parseTraceLine("1,button,2,", event) &&           // empty field
+            !parseTraceLine("1,lift,2", event) &&              // unknown command
+            !parseTraceLine("1,button,4294967296,3", event) && // ID out of int range
+            !parseTraceLine("1,enter,2,-2147483649", event) && // argument out of int range
+            !parseTraceLine("99999999999999999999,process,1", event)); // timestamp overflow
+}
+
+bool Tester::testTraceIngestChunkSplitCase(){
+    string text = "# building 1\n0,add,1,0,20\n1,secure,1,5,1\n2,button,1,12\n3,process,1\n4,enter,1,300\n5,bogus,1\n";
+
+    // A 7 byte chunk splits almost every line across two reads
+    CentCom small(3,1);
+    FILE* trace = makeTrace(text);
+    TraceReplay splitReplay(&small, 7);
+    bool result = splitReplay.ingest(trace);
+    fclose(trace);
+
+    CentCom large(3,1);
+    trace = makeTrace(text);
+    TraceReplay wholeReplay(&large);
+    wholeReplay.ingest(trace);
+    fclose(trace);
+
+    Elevator* elevator = small.getElevator(1);
+    return (result && elevator != nullptr && elevator->m_currentFloor->m_floorNum == 12 &&
+            elevator->checkSecure(5) && elevator->m_load == 300 &&
+            splitReplay.m_lines == 7 && splitReplay.m_events == 5 && splitReplay.m_malformed == 1 &&
+            splitReplay.m_lines == wholeReplay.m_lines && splitReplay.m_events == wholeReplay.m_events &&
+            splitReplay.m_malformed == wholeReplay.m_malformed && splitReplay.m_bytes == (long long)text.size());
+}
+
+bool Tester::testTraceIngestNoTrailingNewlineCase(){
+    CentCom centcom(3,1);
+    FILE* trace = makeTrace("0,add,1,0,20\n1,button,1,9\n2,process,1");
+    TraceReplay replay(&centcom, 5);
+    bool result = replay.ingest(trace);
+    fclose(trace);
+
+    Elevator* elevator = centcom.getElevator(1);
+    return (result && replay.m_events == 3 && replay.m_lastTime == 2 &&
+            elevator != nullptr && elevator->m_currentFloor->m_floorNum == 9); // The unterminated last line is still applied
+}
+
+bool Tester::testTraceIngestLongLineCase(){
+    string comment = "#" + string(300, 'x') + "\n";
+    string data = "0,add,1," + string(300, '0') + "1,20\n"; // valid digits but longer than MAXLINE
+    string text = "0,add,1,0,20\n" + comment + data + "1,button,1,4\n";
+
+    // The same lines must be counted the same way mid chunk and across a chunk boundary
+    int chunkSizes[] = {4096, 7, 64};
+    for (int i = 0; i < 3; i++)
+    {
+        CentCom centcom(3,1);
+        FILE* trace = makeTrace(text);
+        TraceReplay replay(&centcom, chunkSizes[i]);
+        replay.ingest(trace);
+        fclose(trace);
+        if (replay.m_lines != 4 || replay.m_malformed != 1 || replay.m_events != 2 || replay.m_bytes != (long long)text.size())
+            return false;
+    }
+    return true;
+}
+
 
 int main(){
     Tester tester;
@@ -130,14 +402,30 @@ int main(){
     cout<<"Testing Centcom constructor error case: "<< (tester.testCentComConstructorErrorCase()? "Passed":"Failed")<<endl;
     cout<<"Testing CentCom addElevator normal case: "<< (tester.testCentComAddElevatorNormalCase()? "Passed":"Failed")<<endl;
     cout<<"Testing CentCom addElevator error case: "<< (tester.testCentComAddElevatorErrorCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing CentCom addElevator floor limit case: "<< (tester.testCentComAddElevatorFloorLimitCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing CentCom processBatch normal case: "<< (tester.testCentComProcessBatchNormalCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing CentCom processBatch error case: "<< (tester.testCentComProcessBatchErrorCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing CentCom processBatch load case: "<< (tester.testCentComProcessBatchLoadCase()? "Passed":"Failed")<<endl;
 
     //Elevator Tests
     cout<<"Testing Elevator setUp error case: "<< (tester.testElevatorSetUpErrorCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing Elevator setUp top floor case: "<< (tester.testElevatorSetUpTopFloorCase()? "Passed":"Failed")<<endl;
     cout<<"Testing Elevator insertFloor error case: "<< (tester.testElevatorInsertFloorErrorCase()? "Passed": "Failed")<<endl;
     cout<<"Testing Elevator pushButton normal Case: "<< (tester.testElevatorPushButtonNormalCase()? "Passed": "Failed")<<endl;
     cout<<"Testing Elevator pushButton error case: "<< (tester.testElevatorPushButtonErrorCase()? "Passed": "Failed")<<endl;
     cout<<"Testing Elevator processNextRequest normal case: "<< (tester.testElevatorProcessNextRequestNormalCase()? "Passed":"Failed")<<endl;
     cout<<"Testing ELevator processNextRequest error case: "<< (tester.testElevatorProcessNextRequestErrorCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing Elevator pushButton duplicate case: "<< (tester.testElevatorPushButtonDuplicateCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing Elevator processNextRequest floor case: "<< (tester.testElevatorProcessNextRequestFloorCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing Elevator enter error case: "<< (tester.testElevatorEnterErrorCase()? "Passed":"Failed")<<endl;
+
+    //TraceReplay Tests
+    cout<<"Testing TraceReplay constructor error case: "<< (tester.testTraceConstructorErrorCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing TraceReplay parseLine normal case: "<< (tester.testTraceParseLineNormalCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing TraceReplay parseLine error case: "<< (tester.testTraceParseLineErrorCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing TraceReplay ingest chunk split case: "<< (tester.testTraceIngestChunkSplitCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing TraceReplay ingest no trailing newline case: "<< (tester.testTraceIngestNoTrailingNewlineCase()? "Passed":"Failed")<<endl;
+    cout<<"Testing TraceReplay ingest long line case: "<< (tester.testTraceIngestLongLineCase()? "Passed":"Failed")<<endl;
 
 
     return 0;
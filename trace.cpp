@@ -0,0 +1,255 @@
+#include "trace.h"
+#include <cstring>
+#include <climits>
+#include <chrono>
+using namespace std::chrono;
+
+// Parses an optionally signed integer from [p,end), advances p past it
+static bool parseInt(const char *&p, const char *end, long long &value) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9')
+        return false;
+    long long result = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        int digit = *p - '0';
+        if (result > (LLONG_MAX - digit) / 10)
+            return false; // does not fit in a long long
+        result = result * 10 + digit;
+        p++;
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+// Parses an integer that has to fit in an int
+static bool parseField(const char *&p, const char *end, int &value) {
+    long long wide;
+    if (!parseInt(p, end, wide) || wide < INT_MIN || wide > INT_MAX)
+        return false;
+    value = (int)wide;
+    return true;
+}
+
+// Expects a comma at p and steps over it
+static bool skipComma(const char *&p, const char *end) {
+    if (p == end || *p != ',')
+        return false;
+    p++;
+    return true;
+}
+
+// Compares the token [p,end) with a null terminated word
+static bool matchWord(const char *p, const char *end, const char *word) {
+    while (p < end && *word != '\0') {
+        if (*p != *word)
+            return false;
+        p++;
+        word++;
+    }
+    return p == end && *word == '\0';
+}
+
+// Maps a command token to its COMMAND and the number of integer arguments it takes
+static bool parseCommand(const char *p, const char *end, COMMAND &command, int &numArgs) {
+    if (matchWord(p, end, "add")) { command = ADD; numArgs = 2; }
+    else if (matchWord(p, end, "secure")) { command = SECURE; numArgs = 2; }
+    else if (matchWord(p, end, "button")) { command = BUTTON; numArgs = 1; }
+    else if (matchWord(p, end, "process")) { command = PROCESS; numArgs = 0; }
+    else if (matchWord(p, end, "emergency")) { command = EMERGENCY; numArgs = 0; }
+    else if (matchWord(p, end, "clear")) { command = CLEAR; numArgs = 0; }
+    else if (matchWord(p, end, "enter")) { command = ENTER; numArgs = 1; }
+    else if (matchWord(p, end, "exit")) { command = EXIT; numArgs = 1; }
+    else return false;
+    return true;
+}
+
+// TraceReplay constructor: allocates the read buffer and the batch once
+TraceReplay::TraceReplay(CentCom *controller, int chunkSize) {
+    // Input validation
+    if (controller == nullptr)
+        throw invalid_argument("Trace replay needs a controller");
+    if (chunkSize <= 0 || chunkSize > INT_MAX - MAXLINE)
+        throw invalid_argument("Chunk size out of range");
+
+    m_controller = controller;
+    m_chunkSize = chunkSize;
+    m_buffer = new char[m_chunkSize + MAXLINE];
+    try {
+        m_batch = new Event[BATCHSIZE];
+    }
+    catch (...) {
+        delete[] m_buffer; // The destructor does not run if the constructor throws
+        throw;
+    }
+    m_count = 0;
+
+    m_bytes = 0;
+    m_lines = 0;
+    m_events = 0;
+    m_rejected = 0;
+    m_malformed = 0;
+    m_batches = 0;
+    m_batchMin = 0;
+    m_batchMax = 0;
+    m_batchTotal = 0;
+    m_firstTime = 0;
+    m_lastTime = 0;
+}
+
+// TraceReplay destructor: releases the buffers, the controller belongs to the caller
+TraceReplay::~TraceReplay() {
+    delete[] m_buffer;
+    delete[] m_batch;
+    m_buffer = nullptr;
+    m_batch = nullptr;
+    m_controller = nullptr;
+    m_count = 0;
+}
+
+// Parses one line [p,end) into event, the line does not include the newline
+bool TraceReplay::parseLine(const char *p, const char *end, Event &event) {
+    if (end > p && *(end - 1) == '\r')
+        end--; // tolerate CRLF logs
+
+    long long time;
+    if (!parseInt(p, end, time) || !skipComma(p, end))
+        return false;
+    event.m_time = time;
+
+    const char *word = p;
+    while (p < end && *p != ',')
+        p++;
+    int numArgs;
+    if (!parseCommand(word, p, event.m_command, numArgs) || !skipComma(p, end))
+        return false;
+
+    if (!parseField(p, end, event.m_id))
+        return false;
+    event.m_arg1 = 0;
+    event.m_arg2 = 0;
+    if (numArgs >= 1) {
+        if (!skipComma(p, end) || !parseField(p, end, event.m_arg1))
+            return false;
+    }
+    if (numArgs == 2) {
+        if (!skipComma(p, end) || !parseField(p, end, event.m_arg2))
+            return false;
+    }
+    return p == end;
+}
+
+// Sends the pending batch to CentCom and records its latency
+void TraceReplay::flushBatch() {
+    if (m_count == 0)
+        return;
+    steady_clock::time_point start = steady_clock::now();
+    int accepted = m_controller->processBatch(m_batch, m_count);
+    double micros = duration<double, micro>(steady_clock::now() - start).count();
+
+    if (m_batches == 0 || micros < m_batchMin) m_batchMin = micros;
+    if (micros > m_batchMax) m_batchMax = micros;
+    m_batchTotal += micros;
+    m_batches++;
+    m_events += m_count;
+    m_rejected += m_count - accepted;
+    m_count = 0;
+}
+
+// Parses a complete line and queues its event, flushing the batch when full
+void TraceReplay::handleLine(const char *p, const char *end) {
+    m_lines++;
+    if (p == end || *p == '#' || (end - p == 1 && *p == '\r'))
+        return; // blank line or comment
+    if (end - p > MAXLINE) {
+        m_malformed++;
+        return;
+    }
+
+    Event &event = m_batch[m_count];
+    if (!parseLine(p, end, event)) {
+        m_malformed++;
+        return;
+    }
+    if (m_events == 0 && m_count == 0)
+        m_firstTime = event.m_time;
+    m_lastTime = event.m_time;
+
+    m_count++;
+    if (m_count == BATCHSIZE)
+        flushBatch();
+}
+
+// Reads the trace chunk by chunk and feeds every event to the controller
+bool TraceReplay::ingest(FILE *trace) {
+    size_t carry = 0; // bytes of an unfinished line kept at the start of m_buffer
+
+    while (true) {
+        size_t numRead = fread(m_buffer + carry, 1, m_chunkSize, trace);
+        m_bytes += numRead;
+        if (numRead == 0) {
+            if (ferror(trace)) {
+                cout << "Error reading trace file." << endl;
+                flushBatch();
+                return false;
+            }
+            break;
+        }
+
+        const char *p = m_buffer;
+        const char *end = m_buffer + carry + numRead;
+        const char *newline;
+        while ((newline = (const char *)memchr(p, '\n', end - p)) != nullptr) {
+            handleLine(p, newline);
+            p = newline + 1;
+        }
+
+        // Keep the tail for the next chunk unless it is already too long to accept
+        carry = end - p;
+        if (carry > (size_t)MAXLINE) {
+            // Same outcome as handleLine for a long line: comments are skipped,
+            // anything else is malformed
+            m_lines++;
+            if (*p != '#')
+                m_malformed++;
+            int c;
+            while ((c = fgetc(trace)) != EOF && c != '\n')
+                m_bytes++;
+            if (c == '\n')
+                m_bytes++;
+            carry = 0;
+        } else if (carry > 0) {
+            memmove(m_buffer, p, carry);
+        }
+    }
+
+    if (carry > 0) // last line without a trailing newline
+        handleLine(m_buffer, m_buffer + carry);
+    flushBatch();
+    return true;
+}
+
+// Prints counts, throughput and dispatch latency for the run
+void TraceReplay::report(double seconds) {
+    cout << "Lines:      " << m_lines << endl;
+    cout << "Events:     " << m_events << endl;
+    cout << "Rejected:   " << m_rejected << endl;
+    cout << "Malformed:  " << m_malformed << endl;
+    if (m_events > 0)
+        cout << "Trace span: " << m_firstTime << " to " << m_lastTime << endl;
+    cout << "Elapsed:    " << seconds << " s" << endl;
+    if (seconds > 0) {
+        cout << "Throughput: " << (m_bytes / seconds) / (1024.0 * 1024.0) << " MiB/s, "
+             << m_events / seconds << " events/s" << endl;
+    }
+    if (m_batches > 0) {
+        cout << "Batches:    " << m_batches << " of up to " << BATCHSIZE << " events" << endl;
+        cout << "Batch dispatch latency, excluding parsing (us): min " << m_batchMin
+             << ", avg " << m_batchTotal / m_batches
+             << ", max " << m_batchMax << endl;
+        cout << "Per event dispatch latency (us): avg " << m_batchTotal / m_events << endl;
+    }
+}
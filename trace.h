@@ -0,0 +1,68 @@
+#ifndef TRACE_H
+#define TRACE_H
+#include "centcom.h"
+#include <cstdio>
+const int CHUNKSIZE = 1 << 20;  // bytes read from the file at a time
+const int BATCHSIZE = 4096;     // events handed to CentCom per batch
+const int MAXLINE = 256;        // longest accepted line in bytes, without the newline
+class Tester;
+
+/*
+ * Streams a recorded building trace into CentCom.
+ *
+ * The trace is a text file with one event per line:
+ *     timestamp,command,elevatorID[,arg1[,arg2]]
+ * where command is one of
+ *     add       ID bottomFloor topFloor
+ *     secure    ID floor 0|1
+ *     button    ID floor
+ *     process   ID
+ *     emergency ID
+ *     clear     ID
+ *     enter     ID load
+ *     exit      ID load
+ * Empty lines and lines starting with '#' are skipped whatever their length.
+ * Any other line longer than MAXLINE, with a number out of range or with
+ * missing or extra fields is counted as malformed.
+ *
+ * The file is read in fixed size chunks and parsed in place, events are
+ * collected into a fixed size batch and handed to CentCom::processBatch.
+ * The replay itself allocates nothing per line. CentCom holds numElevators
+ * elevators of at most MAXFLOORS floors each, with at most one pending request
+ * per floor and direction, so memory is bounded by the command line arguments,
+ * not by the contents or the length of the trace. An add event for more than
+ * MAXFLOORS floors is rejected.
+ */
+class TraceReplay{
+    friend class Tester;
+    public:
+    TraceReplay(CentCom *controller, int chunkSize = CHUNKSIZE);
+    ~TraceReplay();
+    TraceReplay(const TraceReplay &) = delete;             // owns its buffers, not copyable
+    TraceReplay &operator=(const TraceReplay &) = delete;
+    bool ingest(FILE *trace);       // replays the whole trace, false on a read error
+    void report(double seconds);    // prints counts, throughput and dispatch latency
+    private:
+    static bool parseLine(const char *p, const char *end, Event &event);
+    void handleLine(const char *p, const char *end);
+    void flushBatch();
+
+    CentCom *m_controller;  // receives the events, not owned
+    int m_chunkSize;        // bytes requested per read
+    char *m_buffer;         // one chunk plus the unfinished line carried over
+    Event *m_batch;         // events waiting for the next processBatch call
+    int m_count;            // number of events in m_batch
+
+    long long m_bytes;      // bytes read from the trace
+    long long m_lines;      // lines seen, including skipped ones
+    long long m_events;     // events dispatched
+    long long m_rejected;   // events CentCom or the elevator refused
+    long long m_malformed;  // lines that could not be parsed
+    long long m_batches;
+    double m_batchMin;      // processBatch latency in microseconds, parsing excluded
+    double m_batchMax;
+    double m_batchTotal;
+    long long m_firstTime;  // first and last trace timestamps
+    long long m_lastTime;
+};
+#endif
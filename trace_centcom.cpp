@@ -0,0 +1,60 @@
+#include "trace.h"
+#include <cerrno>
+#include <climits>
+#include <chrono>
+#include <new>
+using namespace std;
+using namespace std::chrono;
+
+// Converts a whole command line argument to an int, false if it is not a number
+static bool parseArgument(const char *text, int &value) {
+    char *end;
+    errno = 0;
+    long result = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || result < INT_MIN || result > INT_MAX)
+        return false;
+    value = (int)result;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " <trace file> <numElevators> [buildingID]" << endl;
+        return 1;
+    }
+    int numElevators;
+    int buildingID = 0;
+    if (!parseArgument(argv[2], numElevators)) {
+        cout << "Invalid number of elevators: " << argv[2] << endl;
+        return 1;
+    }
+    if (argc > 3 && !parseArgument(argv[3], buildingID)) {
+        cout << "Invalid building ID: " << argv[3] << endl;
+        return 1;
+    }
+
+    FILE *trace = fopen(argv[1], "rb");
+    if (trace == nullptr) {
+        cout << "Cannot open trace file " << argv[1] << endl;
+        return 1;
+    }
+
+    bool ok = false;
+    try {
+        CentCom controller(numElevators, buildingID);
+        TraceReplay replay(&controller);
+        steady_clock::time_point start = steady_clock::now();
+        ok = replay.ingest(trace);
+        double seconds = duration<double>(steady_clock::now() - start).count();
+        replay.report(seconds);
+    }
+    catch (const invalid_argument &e) {
+        cout << e.what() << endl;
+    }
+    catch (const bad_alloc &e) {
+        cout << "Not enough memory for " << numElevators << " elevators." << endl;
+    }
+    fclose(trace);
+
+    return ok ? 0 : 1;
+}